@@ -18,23 +18,39 @@ static int write_benchmark_csv(const char* filename, AlgoResult* results, size_t
     // Header ожидается визуализацией
     fprintf(f,
             "algorithm,avg_allocation_time,avg_deallocation_time,"
-            "memory_efficiency,internal_fragmentation,failed_allocations,total_time\n");
+            "memory_efficiency,internal_fragmentation,failed_allocations,total_time,"
+            "local_allocation_ratio,remote_allocation_ratio\n");
 
     for (size_t i = 0; i < count; i++) {
-        fprintf(f, "%s,%.10f,%.10f,%.4f,%zu,%zu,%.10f\n",
+        fprintf(f, "%s,%.10f,%.10f,%.4f,%zu,%zu,%.10f,%.4f,%.4f\n",
                 results[i].name,
                 results[i].result.avg_allocation_time,
                 results[i].result.avg_deallocation_time,
                 results[i].result.memory_efficiency,
                 results[i].result.internal_fragmentation,
                 results[i].result.failed_allocations,
-                results[i].result.total_time);
+                results[i].result.total_time,
+                results[i].result.local_allocation_ratio,
+                results[i].result.remote_allocation_ratio);
     }
 
     fclose(f);
     return 0;
 }
 
+// Фиктивная топология: каждое выделение приходит "с потока" на случайном узле.
+// Последовательность узлов готовится заранее, чтобы rand() не попадал в замеры
+typedef struct {
+    const int* nodes;
+    size_t count;
+    size_t next;
+} FakeTopology;
+
+static int fake_current_node(void* ctx) {
+    FakeTopology* topology = (FakeTopology*)ctx;
+    return topology->nodes[topology->next++ % topology->count];
+}
+
 int main(void) {
     srand((unsigned int)time(NULL));
 
@@ -52,19 +68,110 @@ int main(void) {
         allocation_sizes[i] = 16 + (rand() % 4080); // 16..4096 bytes
     }
 
+    // ALLOCATION_TRACE=path сохраняет размеры запросов для size_class_tuner
+    const char* trace_path = getenv("ALLOCATION_TRACE");
+    if (trace_path) {
+        FILE* trace = fopen(trace_path, "w");
+        if (!trace) {
+            perror("Failed to open allocation trace for writing");
+        } else {
+            for (size_t i = 0; i < num_allocations; i++) {
+                fprintf(trace, "%zu\n", allocation_sizes[i]);
+            }
+            fclose(trace);
+        }
+    }
+
     // Запуск бенчмарков
     BenchmarkResult mk_result = benchmark_algorithm(MCKUSICK_KARELS, pool_size,
                                                     allocation_sizes, num_allocations);
     BenchmarkResult p2_result = benchmark_algorithm(POWER_OF_2, pool_size,
                                                     allocation_sizes, num_allocations);
 
-    AlgoResult results[] = {
+    // Режим NUMA: NUMA_FAKE_NODES=N подменяет топологию на N узлов без mbind
+    NumaConfig numa_config = {0};
+    numa_config.fallback = NUMA_FALLBACK_NEXT_NODE;
+    numa_config.bind_memory = true;
+
+    size_t fake_nodes = 0;
+    const char* fake_env = getenv("NUMA_FAKE_NODES");
+    if (fake_env) {
+        char* end;
+        unsigned long value = strtoul(fake_env, &end, 10);
+        if (fake_env[0] < '0' || fake_env[0] > '9' || *end != '\0' || value == 0) {
+            fprintf(stderr, "Warning: ignoring invalid NUMA_FAKE_NODES=%s\n", fake_env);
+        } else if (value > NUMA_MAX_NODES) {
+            fprintf(stderr, "Warning: NUMA_FAKE_NODES=%s exceeds %d, using %d nodes\n",
+                    fake_env, NUMA_MAX_NODES, NUMA_MAX_NODES);
+            fake_nodes = NUMA_MAX_NODES;
+        } else {
+            fake_nodes = (size_t)value;
+        }
+    }
+
+    FakeTopology fake_topology = {NULL, num_allocations, 0};
+    int* fake_node_sequence = NULL;
+    if (fake_nodes > 0) {
+        fake_node_sequence = (int*)malloc(num_allocations * sizeof(int));
+        if (!fake_node_sequence) {
+            fprintf(stderr, "Failed to allocate memory for fake NUMA topology\n");
+            free(allocation_sizes);
+            return 1;
+        }
+        for (size_t i = 0; i < num_allocations; i++) {
+            fake_node_sequence[i] = (int)((size_t)rand() % fake_nodes);
+        }
+        fake_topology.nodes = fake_node_sequence;
+
+        numa_config.num_nodes = fake_nodes;
+        numa_config.bind_memory = false;
+        numa_config.current_node = fake_current_node;
+        numa_config.current_node_ctx = &fake_topology;
+    }
+
+    BenchmarkResult mk_numa_result = benchmark_numa_algorithm(MCKUSICK_KARELS, pool_size,
+                                                              &numa_config, allocation_sizes,
+                                                              num_allocations);
+    fake_topology.next = 0;  // второй алгоритм получает ту же последовательность узлов
+    BenchmarkResult p2_numa_result = benchmark_numa_algorithm(POWER_OF_2, pool_size,
+                                                              &numa_config, allocation_sizes,
+                                                              num_allocations);
+    free(fake_node_sequence);
+    print_benchmark_results("McKusick-Karels (NUMA)", mk_numa_result);
+    print_benchmark_results("Power-of-2 (NUMA)", p2_numa_result);
+
+    AlgoResult results[5] = {  // последний — место под McKusick-Karels (tuned)
         {"McKusick-Karels", mk_result},
         {"Power-of-2 (Buddy)", p2_result},
+        {"McKusick-Karels (NUMA)", mk_numa_result},
+        {"Power-of-2 (NUMA)", p2_numa_result},
     };
 
+    size_t num_results = 4;
+
+    // MK_SIZE_CLASS_CONFIG=path — раскладка классов от size_class_tuner
+    const char* config_path = getenv("MK_SIZE_CLASS_CONFIG");
+    if (config_path) {
+        MkSizeClassConfig config;
+        if (load_size_class_config(config_path, &config) != 0) {
+            fprintf(stderr, "Failed to load size class config %s\n", config_path);
+        } else if (config.pool_size != 0 && config.pool_size != pool_size) {
+            fprintf(stderr, "Size class config %s was tuned for a %zu byte pool, not %zu\n",
+                    config_path, config.pool_size, pool_size);
+        } else if (config.class_sizes[config.num_classes - 1] > pool_size) {
+            fprintf(stderr, "Size class config %s has classes larger than the %zu byte pool\n",
+                    config_path, pool_size);
+        } else {
+            results[num_results].name = "McKusick-Karels (tuned)";
+            results[num_results].result = benchmark_mk_config(pool_size, &config,
+                                                              allocation_sizes, num_allocations);
+            print_benchmark_results(results[num_results].name, results[num_results].result);
+            num_results++;
+        }
+    }
+
     const char* csv_path = "benchmark_results.csv";
-    if (write_benchmark_csv(csv_path, results, 2) != 0) {
+    if (write_benchmark_csv(csv_path, results, num_results) != 0) {
         free(allocation_sizes);
         return 1;
     }
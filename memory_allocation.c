@@ -1,9 +1,20 @@
+#define _GNU_SOURCE // syscall() и sysconf() недоступны при -std=c11 без этого
 #include "memory_allocation.h"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <math.h>
+#include <stdint.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+// Константа из <numaif.h>, чтобы не зависеть от libnuma
+#define NUMA_MPOL_BIND 2
 
 static size_t next_power_of_2(size_t n) {
     if (n == 0) return 1;
@@ -28,16 +39,192 @@ static size_t log2_size(size_t n) {
     return result;
 }
 
-static McKusickKarelsAllocator* create_mk_allocator(size_t total_size) {
+// Откуда берётся память пула. NULL вместо PoolPlacement — обычный malloc
+typedef struct {
+    bool bind;     // привязать страницы к node через mbind
+    size_t node;
+    bool bound;    // результат mbind, заполняет allocate_pool
+} PoolPlacement;
+
+static size_t page_rounded(size_t size) {
+    long page = sysconf(_SC_PAGESIZE);
+    size_t page_size = page > 0 ? (size_t)page : 4096;
+    return (size + page_size - 1) / page_size * page_size;
+}
+
+static bool bind_range_to_node(void* start, size_t size, size_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    unsigned long nodemask[NUMA_MAX_NODES / (8 * sizeof(unsigned long)) + 1] = {0};
+    nodemask[node / (8 * sizeof(unsigned long))] |= 1UL << (node % (8 * sizeof(unsigned long)));
+
+    return syscall(SYS_mbind, start, (unsigned long)size, NUMA_MPOL_BIND,
+                   nodemask, (unsigned long)(sizeof(nodemask) * 8), 0) == 0;
+#else
+    (void)start;
+    (void)size;
+    (void)node;
+    return false;
+#endif
+}
+
+// Под-пулы NUMA берутся через mmap: память выровнена по страницам, принадлежит
+// только пулу и привязывается к узлу до того, как конструктор её коснётся
+static void* allocate_pool(size_t size, PoolPlacement* placement) {
+    if (!placement) return malloc(size);
+
+    size_t mapped_size = page_rounded(size);
+    void* pool = mmap(NULL, mapped_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pool == MAP_FAILED) return NULL;
+
+    placement->bound = placement->bind &&
+                       bind_range_to_node(pool, mapped_size, placement->node);
+    return pool;
+}
+
+static void release_pool(void* pool, size_t size, bool mapped) {
+    if (!pool) return;
+    if (mapped) {
+        munmap(pool, page_rounded(size));
+    } else {
+        free(pool);
+    }
+}
+
+void mk_default_size_classes(size_t total_size, MkSizeClassConfig* config) {
+    if (!config) return;
+    config->pool_size = total_size;
+    config->num_classes = 0;
+
+    // 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, etc.
+    size_t max_size_class = total_size / 2;
+    for (size_t i = 0; i < MK_NUM_SIZE_CLASSES; i++) {
+
+        if (i >= 60) { // исключаем переполнение
+            break;
+        }
+        size_t size_class = 16ULL << i;  // 16 * 2^i
+        if (size_class > max_size_class) {
+            break;
+        }
+
+        size_t num_blocks = (total_size / 10) / size_class;
+
+        if (num_blocks == 0) num_blocks = 1;
+        if (num_blocks > 100) num_blocks = 100; // чтобы не забить весь пул одним классом
+
+        config->class_sizes[i] = size_class;
+        config->class_blocks[i] = num_blocks;
+        config->num_classes = i + 1;
+    }
+}
+
+bool mk_size_classes_valid(const MkSizeClassConfig* config) {
+    if (!config || config->num_classes == 0 || config->num_classes > MK_NUM_SIZE_CLASSES) {
+        return false;
+    }
+    for (size_t i = 0; i < config->num_classes; i++) {
+        size_t size_class = config->class_sizes[i];
+        // Блок должен вмещать указатель списка и сохранять выравнивание соседей
+        if (size_class < sizeof(void*) || size_class % sizeof(void*) != 0) {
+            return false;
+        }
+        if (i > 0 && size_class <= config->class_sizes[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Беззнаковое число из строки: только цифры (strtoull молча принимает '-'),
+// без переполнения size_t
+bool parse_size_field(char** p, size_t* value) {
+    while (**p == ' ' || **p == '\t') (*p)++;
+    if (**p < '0' || **p > '9') return false;
+
+    errno = 0;
+    char* end;
+    unsigned long long parsed = strtoull(*p, &end, 10);
+    if (errno == ERANGE || parsed > SIZE_MAX) return false;
+
+    *value = (size_t)parsed;
+    *p = end;
+    return true;
+}
+
+// После полей строки допускаются только пробелы и перевод строки
+bool parse_line_end(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return *p == '\0';
+}
+
+int load_size_class_config(const char* path, MkSizeClassConfig* config) {
+    if (!path || !config) return -1;
+
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+
+    // Формат: "pool_size <байт>", затем по строке "<размер класса> <число блоков>";
+    // '#' — комментарий
+    config->pool_size = 0;
+    config->num_classes = 0;
+    char line[256];
+    int status = 0;
+    while (fgets(line, sizeof(line), f)) {
+        char* p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        if (strncmp(p, "pool_size", 9) == 0 && (p[9] == ' ' || p[9] == '\t')) {
+            p += 9;
+            if (!parse_size_field(&p, &config->pool_size) || config->pool_size == 0 ||
+                !parse_line_end(p)) {
+                status = -1;
+                break;
+            }
+            continue;
+        }
+
+        size_t size_class, num_blocks;
+        if (!parse_size_field(&p, &size_class) || !parse_size_field(&p, &num_blocks) ||
+            !parse_line_end(p) || config->num_classes >= MK_NUM_SIZE_CLASSES) {
+            status = -1;
+            break;
+        }
+        config->class_sizes[config->num_classes] = size_class;
+        config->class_blocks[config->num_classes] = num_blocks;
+        config->num_classes++;
+    }
+    fclose(f);
+
+    if (status == 0 && !mk_size_classes_valid(config)) status = -1;
+    return status;
+}
+
+static McKusickKarelsAllocator* create_mk_allocator(size_t total_size,
+                                                    const MkSizeClassConfig* config,
+                                                    PoolPlacement* placement) {
+    MkSizeClassConfig default_config;
+    if (!config) {
+        mk_default_size_classes(total_size, &default_config);
+        config = &default_config;
+    } else if (!mk_size_classes_valid(config) ||
+               config->class_sizes[config->num_classes - 1] > total_size) {
+        return NULL;  // иначе offset + block_size переполнится при нарезке
+    } else if (config->pool_size != 0 && config->pool_size != total_size) {
+        return NULL;  // число блоков рассчитано на пул другого размера
+    }
+
     McKusickKarelsAllocator* mk = (McKusickKarelsAllocator*)malloc(sizeof(McKusickKarelsAllocator));
     if (!mk) return NULL; // Проверка на нехватку памяти
 
-    mk->memory_pool = malloc(total_size);
+    mk->memory_pool = allocate_pool(total_size, placement);
     if (!mk->memory_pool) {
         free(mk);
         return NULL;
     }
 
+    mk->pool_mapped = placement != NULL;
     mk->total_size = total_size;
     mk->used_size = 0;
     mk->num_classes = MK_NUM_SIZE_CLASSES; // MK_NUM_SIZE_CLASSES — константа из .h (храним кол-во классов размеров)
@@ -46,43 +233,22 @@ static McKusickKarelsAllocator* create_mk_allocator(size_t total_size) {
     mk->class_sizes = (size_t*)malloc(mk->num_classes * sizeof(size_t)); // реальный размер каждого блока
     
     if (!mk->free_lists || !mk->class_sizes) {
-        free(mk->memory_pool);
+        release_pool(mk->memory_pool, total_size, mk->pool_mapped);
         free(mk->free_lists);
         free(mk->class_sizes);
         free(mk);
         return NULL;
     }
 
-    // 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, etc.
-    size_t max_size_class = total_size / 2;
-    for (size_t i = 0; i < mk->num_classes; i++) {
-
-        if (i >= 60) { // исключаем переполнение
-            mk->num_classes = i;
-            break;
-        }
-        size_t size_class = 16ULL << i;  // 16 * 2^i
-        if (size_class > max_size_class) {
-            mk->num_classes = i;
-            break;
-        }
-        mk->class_sizes[i] = size_class;
-    }
+    mk->num_classes = config->num_classes;
+    memcpy(mk->class_sizes, config->class_sizes, config->num_classes * sizeof(size_t));
 
     char* pool = (char*)mk->memory_pool; // для удобного передвижения по памяти
     size_t offset = 0;
 
     for (size_t class_idx = 0; class_idx < mk->num_classes && offset < total_size; class_idx++) {
         size_t block_size = mk->class_sizes[class_idx];
-        
-        if (block_size < sizeof(void*)) {
-            continue;
-        }
-        
-        size_t num_blocks = (total_size / 10) / block_size;
-        
-        if (num_blocks == 0) num_blocks = 1;
-        if (num_blocks > 100) num_blocks = 100; // чтобы не забить весь пул одним классом
+        size_t num_blocks = config->class_blocks[class_idx];
 
         for (size_t i = 0; i < num_blocks && offset + block_size <= total_size; i++) {
             // Выравнивание по границе указателя
@@ -150,31 +316,33 @@ static void mk_free(McKusickKarelsAllocator* mk, void* ptr, size_t size) {
 
 static void destroy_mk_allocator(McKusickKarelsAllocator* mk) {
     if (!mk) return;
-    free(mk->memory_pool);
+    release_pool(mk->memory_pool, mk->total_size, mk->pool_mapped);
     free(mk->free_lists);
     free(mk->class_sizes);
     free(mk);
 }
 
-static PowerOf2Allocator* create_power_of_2_allocator(size_t total_size) {
+static PowerOf2Allocator* create_power_of_2_allocator(size_t total_size,
+                                                      PoolPlacement* placement) {
     PowerOf2Allocator* p2 = (PowerOf2Allocator*)malloc(sizeof(PowerOf2Allocator));
     if (!p2) return NULL;
 
     size_t rounded_size = next_power_of_2(total_size); // размер всего пула
     
-    p2->memory_pool = malloc(rounded_size);
+    p2->memory_pool = allocate_pool(rounded_size, placement);
     if (!p2->memory_pool) {
         free(p2);
         return NULL;
     }
 
+    p2->pool_mapped = placement != NULL;
     p2->total_size = rounded_size;
     p2->used_size = 0;
     p2->max_order = log2_size(rounded_size);
 
     p2->free_lists = (BuddyBlock**)calloc(p2->max_order + 1, sizeof(BuddyBlock*));
     if (!p2->free_lists) {
-        free(p2->memory_pool);
+        release_pool(p2->memory_pool, rounded_size, p2->pool_mapped);
         free(p2);
         return NULL;
     }
@@ -300,21 +468,37 @@ static void p2_free(PowerOf2Allocator* p2, void* ptr, size_t size) {
 
 static void destroy_power_of_2_allocator(PowerOf2Allocator* p2) {
     if (!p2) return;
-    free(p2->memory_pool);
+    release_pool(p2->memory_pool, p2->total_size, p2->pool_mapped);
     free(p2->free_lists);
     free(p2);
 }
 
+static MemoryAllocator* create_placed_allocator(AllocationAlgorithm type, size_t total_size,
+                                                const MkSizeClassConfig* config,
+                                                PoolPlacement* placement);
+
 MemoryAllocator* create_allocator(AllocationAlgorithm type, size_t total_size) {
+    return create_allocator_with_config(type, total_size, NULL);
+}
+
+MemoryAllocator* create_allocator_with_config(AllocationAlgorithm type, size_t total_size,
+                                              const MkSizeClassConfig* config) {
+    return create_placed_allocator(type, total_size, config, NULL);
+}
+
+static MemoryAllocator* create_placed_allocator(AllocationAlgorithm type, size_t total_size,
+                                                const MkSizeClassConfig* config,
+                                                PoolPlacement* placement) {
     MemoryAllocator* allocator = (MemoryAllocator*)malloc(sizeof(MemoryAllocator));
     if (!allocator) return NULL;
 
     allocator->type = type;
+    allocator->numa = NULL;
 
     if (type == MCKUSICK_KARELS) {
-        allocator->allocator = create_mk_allocator(total_size);
+        allocator->allocator = create_mk_allocator(total_size, config, placement);
     } else if (type == POWER_OF_2) {
-        allocator->allocator = create_power_of_2_allocator(total_size);
+        allocator->allocator = create_power_of_2_allocator(total_size, placement);
     } else {
         free(allocator);
         return NULL;
@@ -328,10 +512,233 @@ MemoryAllocator* create_allocator(AllocationAlgorithm type, size_t total_size) {
     return allocator;
 }
 
+// Список узлов в формате sysfs ("0", "0-1", "0,2-3"); '-' — диапазон, а не знак.
+// Возвращает число узлов, записанных в node_ids (номера >= NUMA_MAX_NODES пропускаются)
+static size_t parse_numa_node_list(const char* list, size_t* node_ids) {
+    size_t count = 0;
+    const char* p = list;
+    while (*p) {
+        if (*p < '0' || *p > '9') {
+            p++;
+            continue;
+        }
+
+        size_t first = 0;
+        while (*p >= '0' && *p <= '9') {
+            if (first < NUMA_MAX_NODES) first = first * 10 + (size_t)(*p - '0');
+            p++;
+        }
+        size_t last = first;
+        if (*p == '-' && p[1] >= '0' && p[1] <= '9') {
+            p++;
+            last = 0;
+            while (*p >= '0' && *p <= '9') {
+                if (last < NUMA_MAX_NODES) last = last * 10 + (size_t)(*p - '0');
+                p++;
+            }
+        }
+
+        for (size_t node = first; node <= last && node < NUMA_MAX_NODES; node++) {
+            if (count < NUMA_MAX_NODES) node_ids[count++] = node;
+        }
+    }
+    return count;
+}
+
+// Узлы в сети по /sys/devices/system/node/online; без sysfs — один узел 0
+static size_t detect_numa_nodes(size_t* node_ids) {
+    size_t count = 0;
+    FILE* f = fopen("/sys/devices/system/node/online", "r");
+    if (f) {
+        char buf[256];
+        if (fgets(buf, sizeof(buf), f)) {
+            count = parse_numa_node_list(buf, node_ids);
+        }
+        fclose(f);
+    }
+
+    if (count == 0) {
+        node_ids[0] = 0;
+        count = 1;
+    }
+    return count;
+}
+
+// Узел, на котором сейчас выполняется вызывающий поток
+static int getcpu_numa_node(void* ctx) {
+    (void)ctx;
+#if defined(__linux__) && defined(SYS_getcpu)
+    unsigned cpu = 0, node = 0;
+    if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) {
+        return (int)node;
+    }
+#endif
+    return 0;
+}
+
+// Границы пула под-аллокатора (для mbind и поиска владельца указателя)
+static void get_pool_range(MemoryAllocator* allocator, char** start, size_t* size) {
+    if (allocator->type == MCKUSICK_KARELS) {
+        McKusickKarelsAllocator* mk = (McKusickKarelsAllocator*)allocator->allocator;
+        *start = (char*)mk->memory_pool;
+        *size = mk->total_size;
+    } else {
+        PowerOf2Allocator* p2 = (PowerOf2Allocator*)allocator->allocator;
+        *start = (char*)p2->memory_pool;
+        *size = p2->total_size;
+    }
+}
+
+static void destroy_numa_allocator(NumaAllocator* numa) {
+    if (!numa) return;
+    if (numa->node_pools) {
+        for (size_t i = 0; i < numa->num_nodes; i++) {
+            destroy_allocator(numa->node_pools[i]);
+        }
+    }
+    for (size_t i = 0; i < numa->num_locks; i++) {
+        pthread_mutex_destroy(&numa->node_locks[i]);
+    }
+    free(numa->node_pools);
+    free(numa->node_bound);
+    free(numa);
+}
+
+MemoryAllocator* create_numa_allocator(AllocationAlgorithm type, size_t total_size,
+                                       const NumaConfig* config) {
+    if (!config) return NULL;
+    if (type != MCKUSICK_KARELS && type != POWER_OF_2) return NULL;
+
+    // Фиктивная топология нумерует узлы подряд, реальная — берётся из sysfs
+    size_t node_ids[NUMA_MAX_NODES];
+    size_t num_nodes = config->num_nodes;
+    if (num_nodes == 0) {
+        num_nodes = detect_numa_nodes(node_ids);
+    } else if (num_nodes <= NUMA_MAX_NODES) {
+        for (size_t i = 0; i < num_nodes; i++) node_ids[i] = i;
+    }
+    if (num_nodes == 0 || num_nodes > NUMA_MAX_NODES) return NULL;
+
+    MemoryAllocator* allocator = (MemoryAllocator*)malloc(sizeof(MemoryAllocator));
+    NumaAllocator* numa = (NumaAllocator*)calloc(1, sizeof(NumaAllocator));
+    if (!allocator || !numa) {
+        free(allocator);
+        free(numa);
+        return NULL;
+    }
+
+    numa->num_nodes = num_nodes;
+    memcpy(numa->node_ids, node_ids, num_nodes * sizeof(size_t));
+    numa->fallback = config->fallback;
+    numa->current_node = config->current_node ? config->current_node : getcpu_numa_node;
+    numa->current_node_ctx = config->current_node_ctx;
+    atomic_init(&numa->local_allocations, 0);
+    atomic_init(&numa->remote_allocations, 0);
+    for (; numa->num_locks < num_nodes; numa->num_locks++) {
+        if (pthread_mutex_init(&numa->node_locks[numa->num_locks], NULL) != 0) {
+            destroy_numa_allocator(numa);
+            free(allocator);
+            return NULL;
+        }
+    }
+    numa->node_pools = (MemoryAllocator**)calloc(num_nodes, sizeof(MemoryAllocator*));
+    numa->node_bound = (bool*)calloc(num_nodes, sizeof(bool));
+    if (!numa->node_pools || !numa->node_bound) {
+        destroy_numa_allocator(numa);
+        free(allocator);
+        return NULL;
+    }
+
+    // Пул делится поровну между узлами. Buddy-пул округляет размер вверх до
+    // степени двойки, поэтому долю узла заранее округляем вниз — иначе при
+    // числе узлов не степени двойки суммарный пул превысит total_size
+    size_t node_size = total_size / num_nodes;
+    if (type == POWER_OF_2 && node_size > 0 && next_power_of_2(node_size) != node_size) {
+        node_size = next_power_of_2(node_size) / 2;
+    }
+    if (node_size == 0) {
+        destroy_numa_allocator(numa);
+        free(allocator);
+        return NULL;
+    }
+    for (size_t node = 0; node < num_nodes; node++) {
+        PoolPlacement placement = {config->bind_memory, numa->node_ids[node], false};
+        numa->node_pools[node] = create_placed_allocator(type, node_size, NULL, &placement);
+        if (!numa->node_pools[node]) {
+            destroy_numa_allocator(numa);
+            free(allocator);
+            return NULL;
+        }
+        numa->node_bound[node] = placement.bound;
+        if (config->bind_memory && !placement.bound) {
+            fprintf(stderr, "Warning: mbind failed for NUMA node %zu, pool is not bound\n",
+                    numa->node_ids[node]);
+        }
+    }
+
+    allocator->type = type;
+    allocator->allocator = NULL;
+    allocator->numa = numa;
+    return allocator;
+}
+
+static void* numa_allocate(NumaAllocator* numa, size_t size) {
+    // Номер узла переводим в индекс под-пула; неизвестный узел — первый под-пул
+    int current = numa->current_node(numa->current_node_ctx);
+    size_t local = 0;
+    for (size_t i = 0; i < numa->num_nodes; i++) {
+        if (current >= 0 && numa->node_ids[i] == (size_t)current) {
+            local = i;
+            break;
+        }
+    }
+
+    pthread_mutex_lock(&numa->node_locks[local]);
+    void* ptr = allocate_memory(numa->node_pools[local], size);
+    pthread_mutex_unlock(&numa->node_locks[local]);
+    if (ptr) {
+        atomic_fetch_add(&numa->local_allocations, 1);
+        return ptr;
+    }
+
+    if (numa->fallback == NUMA_FALLBACK_NEXT_NODE) {
+        for (size_t i = 1; i < numa->num_nodes; i++) {
+            size_t node = (local + i) % numa->num_nodes;
+            // Чужой под-пул берём под его же блокировку — его потоки работают с ним параллельно
+            pthread_mutex_lock(&numa->node_locks[node]);
+            ptr = allocate_memory(numa->node_pools[node], size);
+            pthread_mutex_unlock(&numa->node_locks[node]);
+            if (ptr) {
+                atomic_fetch_add(&numa->remote_allocations, 1);
+                return ptr;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+static void numa_free(NumaAllocator* numa, void* ptr, size_t size) {
+    // Блок возвращается в пул того узла, которому принадлежит его память
+    for (size_t node = 0; node < numa->num_nodes; node++) {
+        char* start;
+        size_t pool_size;
+        get_pool_range(numa->node_pools[node], &start, &pool_size);
+        if ((char*)ptr >= start && (char*)ptr < start + pool_size) {
+            pthread_mutex_lock(&numa->node_locks[node]);
+            free_memory(numa->node_pools[node], ptr, size);
+            pthread_mutex_unlock(&numa->node_locks[node]);
+            return;
+        }
+    }
+}
+
 void destroy_allocator(MemoryAllocator* allocator) {
     if (!allocator) return;
 
-    if (allocator->type == MCKUSICK_KARELS) {
+    if (allocator->numa) {
+        destroy_numa_allocator(allocator->numa);
+    } else if (allocator->type == MCKUSICK_KARELS) {
         destroy_mk_allocator((McKusickKarelsAllocator*)allocator->allocator);
     } else if (allocator->type == POWER_OF_2) {
         destroy_power_of_2_allocator((PowerOf2Allocator*)allocator->allocator);
@@ -343,7 +750,9 @@ void destroy_allocator(MemoryAllocator* allocator) {
 void* allocate_memory(MemoryAllocator* allocator, size_t size) {
     if (!allocator) return NULL;
 
-    if (allocator->type == MCKUSICK_KARELS) {
+    if (allocator->numa) {
+        return numa_allocate(allocator->numa, size);
+    } else if (allocator->type == MCKUSICK_KARELS) {
         return mk_allocate((McKusickKarelsAllocator*)allocator->allocator, size);
     } else if (allocator->type == POWER_OF_2) {
         return p2_allocate((PowerOf2Allocator*)allocator->allocator, size);
@@ -355,7 +764,9 @@ void* allocate_memory(MemoryAllocator* allocator, size_t size) {
 void free_memory(MemoryAllocator* allocator, void* ptr, size_t size) {
     if (!allocator || !ptr) return;
 
-    if (allocator->type == MCKUSICK_KARELS) {
+    if (allocator->numa) {
+        numa_free(allocator->numa, ptr, size);
+    } else if (allocator->type == MCKUSICK_KARELS) {
         mk_free((McKusickKarelsAllocator*)allocator->allocator, ptr, size);
     } else if (allocator->type == POWER_OF_2) {
         p2_free((PowerOf2Allocator*)allocator->allocator, ptr, size);
@@ -365,6 +776,22 @@ void free_memory(MemoryAllocator* allocator, void* ptr, size_t size) {
 void print_memory_status(MemoryAllocator* allocator) {
     if (!allocator) return;
 
+    if (allocator->numa) {
+        NumaAllocator* numa = allocator->numa;
+        printf("\n=== NUMA Status ===\n");
+        printf("Nodes: %zu\n", numa->num_nodes);
+        printf("Fallback: %s\n",
+               numa->fallback == NUMA_FALLBACK_NEXT_NODE ? "next node" : "none");
+        printf("Local Allocations: %zu\n", atomic_load(&numa->local_allocations));
+        printf("Remote Allocations: %zu\n", atomic_load(&numa->remote_allocations));
+        for (size_t node = 0; node < numa->num_nodes; node++) {
+            printf("Node %zu (%s):", numa->node_ids[node],
+                   numa->node_bound[node] ? "bound" : "not bound");
+            print_memory_status(numa->node_pools[node]);
+        }
+        return;
+    }
+
     printf("\n=== Memory Status ===\n");
 
     if (allocator->type == MCKUSICK_KARELS) {
@@ -388,11 +815,10 @@ void print_memory_status(MemoryAllocator* allocator) {
     printf("====================\n\n");
 }
 
-BenchmarkResult benchmark_algorithm(AllocationAlgorithm algorithm, size_t pool_size,
+// Прогоняет сценарий на готовом аллокаторе и уничтожает его
+static BenchmarkResult run_benchmark(MemoryAllocator* allocator, AllocationAlgorithm algorithm,
                                      size_t* allocation_sizes, size_t num_allocations) {
     BenchmarkResult result = {0};  // Обнуляем структуру
-    // Создаем аллокатор
-    MemoryAllocator* allocator = create_allocator(algorithm, pool_size);
     if (!allocator) return result;  // Если не удалось создать
 
     // Выделяем массивы для хранения указателей и размеров
@@ -431,12 +857,14 @@ BenchmarkResult benchmark_algorithm(AllocationAlgorithm algorithm, size_t pool_s
             
             // Вычисляем реально выделенный размер
             if (algorithm == MCKUSICK_KARELS) {
-                // Ищем класс размеров
-                size_t size_class = 16;
-                while (size_class < allocation_sizes[i]) {
-                    size_class <<= 1;  // Умножаем на 2
+                // Ищем класс размеров (у всех узлов NUMA классы одинаковые)
+                MemoryAllocator* pool = allocator->numa ? allocator->numa->node_pools[0] : allocator;
+                McKusickKarelsAllocator* mk = (McKusickKarelsAllocator*)pool->allocator;
+                size_t class_idx = 0;
+                while (mk->class_sizes[class_idx] < allocation_sizes[i]) {
+                    class_idx++;
                 }
-                total_allocated += size_class;
+                total_allocated += mk->class_sizes[class_idx];
             } else if (algorithm == POWER_OF_2) {
                 // Buddy system: размер + заголовок, округленный до степени двойки
                 size_t rounded = next_power_of_2(allocation_sizes[i] + sizeof(BuddyBlock));
@@ -451,6 +879,14 @@ BenchmarkResult benchmark_algorithm(AllocationAlgorithm algorithm, size_t pool_s
     // Среднее время выделения
     result.avg_allocation_time = total_alloc_time / num_allocations;
 
+    // Доли локальных и удалённых выделений (только для режима NUMA)
+    if (allocator->numa && successful_allocations > 0) {
+        result.local_allocation_ratio =
+            (double)atomic_load(&allocator->numa->local_allocations) / successful_allocations;
+        result.remote_allocation_ratio =
+            (double)atomic_load(&allocator->numa->remote_allocations) / successful_allocations;
+    }
+
     // Вычисляем фрагментацию и эффективность
     if (total_requested > 0 && total_allocated > 0) {
         // Внутренняя фрагментация = выделено - запрошено
@@ -487,6 +923,25 @@ BenchmarkResult benchmark_algorithm(AllocationAlgorithm algorithm, size_t pool_s
     return result;
 }
 
+BenchmarkResult benchmark_algorithm(AllocationAlgorithm algorithm, size_t pool_size,
+                                     size_t* allocation_sizes, size_t num_allocations) {
+    return run_benchmark(create_allocator(algorithm, pool_size), algorithm,
+                         allocation_sizes, num_allocations);
+}
+
+BenchmarkResult benchmark_mk_config(size_t pool_size, const MkSizeClassConfig* config,
+                                    size_t* allocation_sizes, size_t num_allocations) {
+    return run_benchmark(create_allocator_with_config(MCKUSICK_KARELS, pool_size, config),
+                         MCKUSICK_KARELS, allocation_sizes, num_allocations);
+}
+
+BenchmarkResult benchmark_numa_algorithm(AllocationAlgorithm algorithm, size_t pool_size,
+                                          const NumaConfig* config,
+                                          size_t* allocation_sizes, size_t num_allocations) {
+    return run_benchmark(create_numa_allocator(algorithm, pool_size, config), algorithm,
+                         allocation_sizes, num_allocations);
+}
+
 void print_benchmark_results(const char* algorithm_name, BenchmarkResult result) {
     printf("\n=== %s Results ===\n", algorithm_name);
     printf("Average Allocation Time:   %.6f seconds\n", result.avg_allocation_time);
@@ -495,6 +950,10 @@ void print_benchmark_results(const char* algorithm_name, BenchmarkResult result)
     printf("Memory Efficiency:         %.2f%%\n", result.memory_efficiency);
     printf("Failed Allocations:        %zu\n", result.failed_allocations);
     printf("Total Time:                %.6f seconds\n", result.total_time);
+    if (result.local_allocation_ratio > 0 || result.remote_allocation_ratio > 0) {
+        printf("Local Allocations:         %.2f%%\n", result.local_allocation_ratio * 100.0);
+        printf("Remote Allocations:        %.2f%%\n", result.remote_allocation_ratio * 100.0);
+    }
     printf("===============================\n");
 }
 
@@ -3,6 +3,8 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
 
 typedef enum {
     MCKUSICK_KARELS,  
@@ -17,8 +19,25 @@ typedef struct {
     size_t total_size;
     size_t used_size;
     size_t num_classes;
+    bool pool_mapped;     // пул получен через mmap (под-пул NUMA)
 } McKusickKarelsAllocator;
 
+// Раскладка классов размеров: границы классов и число заранее нарезанных блоков
+typedef struct {
+    size_t pool_size;   // размер пула, под который посчитаны class_blocks (0 — любой)
+    size_t num_classes;
+    size_t class_sizes[MK_NUM_SIZE_CLASSES];   // по возрастанию, кратны sizeof(void*)
+    size_t class_blocks[MK_NUM_SIZE_CLASSES];
+} MkSizeClassConfig;
+
+void mk_default_size_classes(size_t total_size, MkSizeClassConfig* config);
+bool mk_size_classes_valid(const MkSizeClassConfig* config);
+int load_size_class_config(const char* path, MkSizeClassConfig* config);
+
+// Разбор чисел из текстовых файлов: только цифры, без переполнения size_t
+bool parse_size_field(char** p, size_t* value);
+bool parse_line_end(const char* p);
+
 #define MAX_ORDER 20
 typedef struct BuddyBlock {
     size_t order;       
@@ -32,14 +51,54 @@ typedef struct {
     size_t total_size;
     size_t used_size;
     size_t max_order;
+    bool pool_mapped;     // пул получен через mmap (под-пул NUMA)
 } PowerOf2Allocator;
 
+typedef enum {
+    NUMA_FALLBACK_NONE,       // локальный узел исчерпан — выделение неудачно
+    NUMA_FALLBACK_NEXT_NODE   // перебираем остальные узлы по кругу
+} NumaFallbackPolicy;
+
+#define NUMA_MAX_NODES 64
 typedef struct {
+    size_t num_nodes;               // 0 — узлы из /sys/devices/system/node/online,
+                                    // иначе фиктивные узлы 0..num_nodes-1
+    NumaFallbackPolicy fallback;
+    bool bind_memory;               // привязывать пулы к узлам через mbind
+    int (*current_node)(void* ctx); // NULL — узел вызывающего потока через getcpu;
+                                    // вызывается из разных потоков без блокировок
+    void* current_node_ctx;
+} NumaConfig;
+
+typedef struct MemoryAllocator MemoryAllocator;
+
+// Под-пул каждого узла защищён своей блокировкой, поэтому allocate_memory и
+// free_memory можно вызывать из нескольких потоков одновременно
+typedef struct {
+    size_t num_nodes;
+    size_t node_ids[NUMA_MAX_NODES]; // номер узла для каждого под-пула
+    MemoryAllocator** node_pools;   // по одному под-пулу на узел
+    bool* node_bound;               // удалось ли выполнить mbind для узла
+    pthread_mutex_t node_locks[NUMA_MAX_NODES];
+    size_t num_locks;               // сколько блокировок инициализировано
+    NumaFallbackPolicy fallback;
+    int (*current_node)(void* ctx);
+    void* current_node_ctx;
+    atomic_size_t local_allocations;
+    atomic_size_t remote_allocations;
+} NumaAllocator;
+
+struct MemoryAllocator {
     AllocationAlgorithm type;
     void* allocator;
-} MemoryAllocator;
+    NumaAllocator* numa;  // NULL для обычного (одного) пула
+};
 
 MemoryAllocator* create_allocator(AllocationAlgorithm type, size_t total_size);
+MemoryAllocator* create_allocator_with_config(AllocationAlgorithm type, size_t total_size,
+                                              const MkSizeClassConfig* config);
+MemoryAllocator* create_numa_allocator(AllocationAlgorithm type, size_t total_size,
+                                       const NumaConfig* config);
 void destroy_allocator(MemoryAllocator* allocator);
 void* allocate_memory(MemoryAllocator* allocator, size_t size);
 void free_memory(MemoryAllocator* allocator, void* ptr, size_t size);
@@ -53,10 +112,17 @@ typedef struct {
     size_t failed_allocations;
     double total_time;
     double memory_efficiency;
+    double local_allocation_ratio;   // доля выделений с локального узла NUMA
+    double remote_allocation_ratio;  // доля выделений с удалённого узла NUMA
 } BenchmarkResult;
 
 BenchmarkResult benchmark_algorithm(AllocationAlgorithm algorithm, size_t pool_size,
                                      size_t* allocation_sizes, size_t num_allocations);
+BenchmarkResult benchmark_mk_config(size_t pool_size, const MkSizeClassConfig* config,
+                                    size_t* allocation_sizes, size_t num_allocations);
+BenchmarkResult benchmark_numa_algorithm(AllocationAlgorithm algorithm, size_t pool_size,
+                                          const NumaConfig* config,
+                                          size_t* allocation_sizes, size_t num_allocations);
 void print_benchmark_results(const char* algorithm_name, BenchmarkResult result);
 void compare_algorithms(size_t pool_size, size_t* allocation_sizes, size_t num_allocations);
 
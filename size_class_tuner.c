@@ -0,0 +1,410 @@
+#include "memory_allocation.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+// Подбор классов размеров McKusick-Karels под записанную нагрузку.
+//
+// Вход — гистограмма ("<размер> <количество>" в строке) или трасса
+// выделений (один размер в строке). Границы классов ищутся динамическим
+// программированием по минимуму внутренней фрагментации, затем бюджет пула
+// распределяется между классами так, чтобы было меньше неудачных выделений;
+// поиск повторяется по запросам, которым хватило бюджета.
+
+#define TUNER_MAX_BUCKETS 1024
+
+typedef struct {
+    size_t size;       // верхняя граница корзины (кратна granularity)
+    size_t count;      // число запросов в корзине
+    size_t requested;  // сумма запрошенных байт
+} SizeBucket;
+
+typedef struct {
+    size_t served;
+    size_t failed;
+    size_t requested;
+    size_t allocated;
+    double memory_efficiency;
+} Projection;
+
+static size_t round_up(size_t n, size_t granularity) {
+    return (n + granularity - 1) / granularity * granularity;
+}
+
+static int compare_buckets(const void* a, const void* b) {
+    size_t sa = ((const SizeBucket*)a)->size;
+    size_t sb = ((const SizeBucket*)b)->size;
+    return (sa > sb) - (sa < sb);
+}
+
+// Сливает корзины с одинаковой границей; массив должен быть отсортирован
+static size_t merge_buckets(SizeBucket* buckets, size_t count) {
+    size_t out = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (out > 0 && buckets[out - 1].size == buckets[i].size) {
+            buckets[out - 1].count += buckets[i].count;
+            buckets[out - 1].requested += buckets[i].requested;
+        } else {
+            buckets[out++] = buckets[i];
+        }
+    }
+    return out;
+}
+
+static SizeBucket* read_histogram(const char* path, size_t* num_buckets) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        perror("Failed to open workload file");
+        return NULL;
+    }
+
+    size_t capacity = 256, count = 0;
+    SizeBucket* buckets = (SizeBucket*)malloc(capacity * sizeof(SizeBucket));
+    if (!buckets) {
+        fprintf(stderr, "Failed to allocate memory for size histogram\n");
+        fclose(f);
+        return NULL;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        // Те же правила, что в load_size_class_config; пустые строки,
+        // комментарии и строки с мусором пропускаются
+        char* p = line;
+        size_t size, times = 1;
+        if (!parse_size_field(&p, &size)) continue;
+        if (!parse_line_end(p) && (!parse_size_field(&p, &times) || !parse_line_end(p))) {
+            continue;
+        }
+        if (size == 0 || times == 0 || size > SIZE_MAX / times) continue;  // size * times переполнится
+
+        if (count == capacity) {
+            capacity *= 2;
+            SizeBucket* grown = (SizeBucket*)realloc(buckets, capacity * sizeof(SizeBucket));
+            if (!grown) {
+                fprintf(stderr, "Failed to allocate memory for size histogram\n");
+                free(buckets);
+                fclose(f);
+                return NULL;
+            }
+            buckets = grown;
+        }
+        buckets[count].size = size;
+        buckets[count].count = times;
+        buckets[count].requested = size * times;
+        count++;
+
+        // Трасса может быть длинной — периодически сжимаем одинаковые размеры
+        if (count == capacity) {
+            qsort(buckets, count, sizeof(SizeBucket), compare_buckets);
+            count = merge_buckets(buckets, count);
+        }
+    }
+    fclose(f);
+
+    qsort(buckets, count, sizeof(SizeBucket), compare_buckets);
+    *num_buckets = merge_buckets(buckets, count);
+    return buckets;
+}
+
+// Округляет размеры до границ кандидатов; при слишком большом числе
+// различных размеров шаг удваивается, чтобы перебор оставался быстрым.
+// Возвращает -1 при нехватке памяти
+static int quantize_buckets(SizeBucket* buckets, size_t count, size_t* merged_count) {
+    size_t granularity = sizeof(void*);
+    for (;;) {
+        SizeBucket* tmp = (SizeBucket*)malloc(count * sizeof(SizeBucket));
+        if (!tmp) return -1;
+        for (size_t i = 0; i < count; i++) {
+            tmp[i] = buckets[i];
+            tmp[i].size = round_up(buckets[i].size, granularity);
+        }
+        size_t merged = merge_buckets(tmp, count);
+        if (merged <= TUNER_MAX_BUCKETS) {
+            memcpy(buckets, tmp, merged * sizeof(SizeBucket));
+            free(tmp);
+            *merged_count = merged;
+            return 0;
+        }
+        free(tmp);
+        granularity *= 2;
+    }
+}
+
+// Оптимальные границы классов: классы — подмножество границ корзин,
+// последний класс обязательно покрывает самую большую корзину
+static size_t search_class_boundaries(const SizeBucket* buckets, size_t n,
+                                      size_t max_classes, size_t* class_sizes) {
+    if (max_classes > n) max_classes = n;
+
+    // Префиксные суммы количества и запрошенных байт
+    double* count_sum = (double*)calloc(n + 1, sizeof(double));
+    double* req_sum = (double*)calloc(n + 1, sizeof(double));
+    // cost[k][j] — минимальная фрагментация первых j корзин при k классах
+    double* cost = (double*)malloc((max_classes + 1) * (n + 1) * sizeof(double));
+    size_t* split = (size_t*)malloc((max_classes + 1) * (n + 1) * sizeof(size_t));
+    if (!count_sum || !req_sum || !cost || !split) {
+        free(count_sum);
+        free(req_sum);
+        free(cost);
+        free(split);
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        count_sum[i + 1] = count_sum[i] + (double)buckets[i].count;
+        req_sum[i + 1] = req_sum[i] + (double)buckets[i].requested;
+    }
+
+#define COST(k, j) cost[(k) * (n + 1) + (j)]
+#define SPLIT(k, j) split[(k) * (n + 1) + (j)]
+    for (size_t j = 1; j <= n; j++) {
+        COST(1, j) = (double)buckets[j - 1].size * count_sum[j] - req_sum[j];
+        SPLIT(1, j) = 0;
+    }
+    for (size_t k = 2; k <= max_classes; k++) {
+        for (size_t j = k; j <= n; j++) {
+            double best = -1;
+            size_t best_i = k - 1;
+            // Класс k покрывает корзины i..j-1 с размером блока buckets[j-1]
+            for (size_t i = k - 1; i < j; i++) {
+                double c = COST(k - 1, i) + (double)buckets[j - 1].size *
+                           (count_sum[j] - count_sum[i]) - (req_sum[j] - req_sum[i]);
+                if (best < 0 || c < best) {
+                    best = c;
+                    best_i = i;
+                }
+            }
+            COST(k, j) = best;
+            SPLIT(k, j) = best_i;
+        }
+    }
+
+    size_t j = n;
+    for (size_t k = max_classes; k >= 1; k--) {
+        class_sizes[k - 1] = buckets[j - 1].size;
+        j = SPLIT(k, j);
+    }
+#undef COST
+#undef SPLIT
+
+    free(count_sum);
+    free(req_sum);
+    free(cost);
+    free(split);
+    return max_classes;
+}
+
+// Число запросов, попадающих в каждый класс (первый класс не меньше запроса)
+static void class_demand(const MkSizeClassConfig* config, const SizeBucket* buckets, size_t n,
+                         size_t* demand, size_t* requested, size_t* unfit) {
+    memset(demand, 0, MK_NUM_SIZE_CLASSES * sizeof(size_t));
+    memset(requested, 0, MK_NUM_SIZE_CLASSES * sizeof(size_t));
+    *unfit = 0;
+    for (size_t i = 0; i < n; i++) {
+        size_t class_idx = 0;
+        while (class_idx < config->num_classes &&
+               config->class_sizes[class_idx] < buckets[i].size) {
+            class_idx++;
+        }
+        if (class_idx >= config->num_classes) {
+            *unfit += buckets[i].count;
+            continue;
+        }
+        demand[class_idx] += buckets[i].count;
+        requested[class_idx] += buckets[i].requested;
+    }
+}
+
+// Распределяет бюджет: сначала мелкие классы (больше запросов на байт),
+// остаток — пропорционально спросу как запас на колебания нагрузки
+static void plan_class_blocks(MkSizeClassConfig* config, const size_t* demand, size_t budget) {
+    size_t remaining = budget;
+    for (size_t k = 0; k < config->num_classes; k++) {
+        size_t fit = remaining / config->class_sizes[k];
+        config->class_blocks[k] = demand[k] < fit ? demand[k] : fit;
+        remaining -= config->class_blocks[k] * config->class_sizes[k];
+    }
+
+    double demand_bytes = 0;
+    for (size_t k = 0; k < config->num_classes; k++) {
+        demand_bytes += (double)demand[k] * config->class_sizes[k];
+    }
+    if (demand_bytes <= 0) return;
+
+    double leftover = (double)remaining;
+    for (size_t k = 0; k < config->num_classes; k++) {
+        size_t extra = (size_t)(leftover * (double)demand[k] / demand_bytes);
+        config->class_blocks[k] += extra;
+        remaining -= extra * config->class_sizes[k];
+    }
+}
+
+// Границы и число блоков с учётом бюджета. Классы, которым не досталось ни
+// одного блока, ничего не обслуживают и только занимают слоты: их корзины
+// убираются из кандидатов, и поиск повторяется по обслуживаемым корзинам,
+// пока набор не перестанет меняться. candidates сокращается на месте
+static int tune_size_classes(const SizeBucket* buckets, size_t num_buckets,
+                             SizeBucket* candidates, size_t num_candidates,
+                             size_t budget, MkSizeClassConfig* tuned) {
+    for (;;) {
+        tuned->num_classes = search_class_boundaries(candidates, num_candidates,
+                                                     MK_NUM_SIZE_CLASSES, tuned->class_sizes);
+        if (tuned->num_classes == 0) return -1;
+
+        size_t demand[MK_NUM_SIZE_CLASSES], requested[MK_NUM_SIZE_CLASSES], unfit;
+        class_demand(tuned, buckets, num_buckets, demand, requested, &unfit);
+        plan_class_blocks(tuned, demand, budget);
+
+        // Граница каждого класса — одна из корзин, поэтому класс без блоков
+        // всегда убирает хотя бы одну корзину и цикл конечен
+        size_t kept = 0, class_idx = 0;
+        for (size_t i = 0; i < num_candidates; i++) {
+            while (tuned->class_sizes[class_idx] < candidates[i].size) class_idx++;
+            if (tuned->class_blocks[class_idx] > 0) candidates[kept++] = candidates[i];
+        }
+        if (kept == num_candidates) return 0;
+        num_candidates = kept;
+    }
+}
+
+// Прогноз для сценария бенчмарка: все запросы живы одновременно
+static Projection project(const MkSizeClassConfig* config, const SizeBucket* buckets, size_t n,
+                          size_t budget) {
+    Projection p = {0};
+    size_t demand[MK_NUM_SIZE_CLASSES], requested[MK_NUM_SIZE_CLASSES], unfit;
+    class_demand(config, buckets, n, demand, requested, &unfit);
+    p.failed = unfit;
+
+    // Блоки нарезаются по порядку, пока хватает места — как в create_mk_allocator
+    size_t offset = 0;
+    for (size_t k = 0; k < config->num_classes; k++) {
+        size_t size_class = config->class_sizes[k];
+        size_t fit = offset < budget ? (budget - offset) / size_class : 0;
+        size_t blocks = config->class_blocks[k] < fit ? config->class_blocks[k] : fit;
+        offset += blocks * size_class;
+
+        size_t served = demand[k] < blocks ? demand[k] : blocks;
+        p.served += served;
+        p.failed += demand[k] - served;
+        p.allocated += served * size_class;
+        if (demand[k] > 0) {
+            p.requested += (size_t)((double)requested[k] * served / demand[k]);
+        }
+    }
+
+    if (p.allocated > 0) {
+        p.memory_efficiency = (double)p.requested / p.allocated * 100.0;
+    }
+    return p;
+}
+
+static int write_config(const char* path, const MkSizeClassConfig* config, size_t budget) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        perror("Failed to open config for writing");
+        return -1;
+    }
+    fprintf(f, "# McKusick-Karels size classes; block counts are valid only for this pool size\n");
+    fprintf(f, "pool_size %zu\n", budget);
+    fprintf(f, "# size_class num_blocks\n");
+    for (size_t k = 0; k < config->num_classes; k++) {
+        fprintf(f, "%zu %zu\n", config->class_sizes[k], config->class_blocks[k]);
+    }
+    fclose(f);
+    return 0;
+}
+
+static void print_projection(const char* name, const MkSizeClassConfig* config, Projection p) {
+    printf("%-10s %-10zu %-15.2f %-15zu %-10zu\n", name, config->num_classes,
+           p.memory_efficiency, p.allocated - p.requested, p.failed);
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <histogram|trace> <pool_size> [output.conf]\n", argv[0]);
+        return 1;
+    }
+
+    const char* input_path = argv[1];
+    const char* output_path = argc > 3 ? argv[3] : "size_classes.conf";
+
+    // Размер пула — целое число байт без знака и суффиксов
+    char* budget_arg = argv[2];
+    size_t budget = 0;
+    if (!parse_size_field(&budget_arg, &budget) || *budget_arg != '\0' || budget == 0) {
+        fprintf(stderr, "Pool size must be a positive number of bytes, got '%s'\n", argv[2]);
+        fprintf(stderr, "Usage: %s <histogram|trace> <pool_size> [output.conf]\n", argv[0]);
+        return 1;
+    }
+
+    size_t num_buckets = 0;
+    SizeBucket* buckets = read_histogram(input_path, &num_buckets);
+    if (!buckets) return 1;
+    if (num_buckets == 0) {
+        fprintf(stderr, "No allocation sizes in %s\n", input_path);
+        free(buckets);
+        return 1;
+    }
+
+    // Для прогноза используются точные размеры, для поиска — квантованные
+    SizeBucket* candidates = (SizeBucket*)malloc(num_buckets * sizeof(SizeBucket));
+    if (!candidates) {
+        fprintf(stderr, "Failed to allocate memory for size buckets\n");
+        free(buckets);
+        return 1;
+    }
+    memcpy(candidates, buckets, num_buckets * sizeof(SizeBucket));
+    size_t num_candidates = 0;
+    if (quantize_buckets(candidates, num_buckets, &num_candidates) != 0) {
+        fprintf(stderr, "Failed to allocate memory for size buckets\n");
+        free(candidates);
+        free(buckets);
+        return 1;
+    }
+
+    // Запросы больше пула не обслужить ни при какой раскладке
+    while (num_candidates > 0 && candidates[num_candidates - 1].size > budget) {
+        num_candidates--;
+    }
+    if (num_candidates == 0) {
+        fprintf(stderr, "Every request exceeds the pool size\n");
+        free(candidates);
+        free(buckets);
+        return 1;
+    }
+
+    MkSizeClassConfig tuned = {0};
+    int status = tune_size_classes(buckets, num_buckets, candidates, num_candidates,
+                                   budget, &tuned);
+    free(candidates);
+    if (status != 0) {
+        fprintf(stderr, "Failed to allocate memory for class boundary search\n");
+        free(buckets);
+        return 1;
+    }
+    tuned.pool_size = budget;
+
+    MkSizeClassConfig baseline;
+    mk_default_size_classes(budget, &baseline);
+
+    Projection default_p = project(&baseline, buckets, num_buckets, budget);
+    Projection tuned_p = project(&tuned, buckets, num_buckets, budget);
+    free(buckets);
+
+    printf("\nPool Size: %zu bytes\n", budget);
+    printf("\n%-10s %-10s %-15s %-15s %-10s\n",
+           "Layout", "Classes", "Efficiency (%)", "Int. Frag (B)", "Failed");
+    printf("────────────────────────────────────────────────────────────\n");
+    print_projection("Default", &baseline, default_p);
+    print_projection("Tuned", &tuned, tuned_p);
+    printf("────────────────────────────────────────────────────────────\n");
+    printf("Projected gain: %+.2f pp efficiency, %+lld failed allocations\n\n",
+           tuned_p.memory_efficiency - default_p.memory_efficiency,
+           (long long)tuned_p.failed - (long long)default_p.failed);
+
+    if (write_config(output_path, &tuned, budget) != 0) return 1;
+    printf("✓ Size class config saved to %s\n", output_path);
+    return 0;
+}
@@ -6,6 +6,8 @@ Expected CSV (benchmark_results.csv by default) columns:
     algorithm, avg_allocation_time, avg_deallocation_time,
     memory_efficiency, internal_fragmentation,
     failed_allocations, total_time
+Optional NUMA columns (local_allocation_ratio, remote_allocation_ratio)
+are ignored by the plots.
 
 If the CSV is absent, synthetic sample data will be generated.
 """